@@ -0,0 +1,115 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Connection must be constructible from a connection string and report
+// is_open(); Database instantiates it with pqxx::connection.
+template <typename Connection>
+class BasicConnectionPool {
+public:
+    // Returns the connection to the pool when destroyed.
+    class Lease {
+    public:
+        Lease(BasicConnectionPool* pool, std::unique_ptr<Connection> conn)
+            : pool_(pool), conn_(std::move(conn)) {}
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr)), conn_(std::move(other.conn_)) {}
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() {
+            if (pool_) {
+                pool_->release(std::move(conn_));
+            }
+        }
+
+        Connection& operator*() { return *conn_; }
+        Connection* operator->() { return conn_.get(); }
+
+    private:
+        BasicConnectionPool* pool_;
+        std::unique_ptr<Connection> conn_;
+    };
+
+    BasicConnectionPool(std::string conn_str, std::size_t size);
+
+    Lease acquire();
+
+    // Drops idle connections, e.g. after the server behind them went away.
+    void clear_idle();
+
+    // Connections currently open, both idle and leased.
+    std::size_t open_connections() const;
+
+private:
+    void release(std::unique_ptr<Connection> conn);
+
+    std::string conn_str_;
+    std::size_t size_;
+    std::size_t created_ = 0;
+    std::vector<std::unique_ptr<Connection>> idle_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+};
+
+template <typename Connection>
+BasicConnectionPool<Connection>::BasicConnectionPool(std::string conn_str, std::size_t size)
+    : conn_str_(std::move(conn_str)), size_(size == 0 ? 1 : size) {
+}
+
+template <typename Connection>
+typename BasicConnectionPool<Connection>::Lease BasicConnectionPool<Connection>::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !idle_.empty() || created_ < size_; });
+
+    if (!idle_.empty()) {
+        auto conn = std::move(idle_.back());
+        idle_.pop_back();
+        return Lease(this, std::move(conn));
+    }
+
+    ++created_;
+    lock.unlock();
+
+    try {
+        auto conn = std::make_unique<Connection>(conn_str_);
+        return Lease(this, std::move(conn));
+    } catch (...) {
+        lock.lock();
+        --created_;
+        cv_.notify_one();
+        throw;
+    }
+}
+
+template <typename Connection>
+void BasicConnectionPool<Connection>::clear_idle() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    created_ -= idle_.size();
+    idle_.clear();
+    cv_.notify_all();
+}
+
+template <typename Connection>
+std::size_t BasicConnectionPool<Connection>::open_connections() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return created_;
+}
+
+template <typename Connection>
+void BasicConnectionPool<Connection>::release(std::unique_ptr<Connection> conn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Broken connections are dropped so the next acquire reconnects.
+    if (conn && conn->is_open()) {
+        idle_.push_back(std::move(conn));
+    } else {
+        --created_;
+    }
+    cv_.notify_one();
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "db/connection_pool.h"
+#include "db/read_routing.h"
+#include "db/user.h"
 #include <pqxx/pqxx>
 #include <string>
 #include <memory>
@@ -9,15 +12,7 @@
 
 using json = nlohmann::json;
 
-struct User {
-    std::string id;
-    std::string username;
-    std::string email;
-    std::string first_name;
-    std::string last_name;
-    std::string created_at;
-    std::string updated_at;
-};
+using ConnectionPool = BasicConnectionPool<pqxx::connection>;
 
 class Database {
 public:
@@ -43,8 +38,27 @@ public:
 
 private:
     Database();
-    std::unique_ptr<pqxx::connection> conn_;
+    std::unique_ptr<ConnectionPool> primary_;
+    std::vector<std::unique_ptr<ConnectionPool>> replicas_;
+    std::unique_ptr<ReplicaSelector> replica_selector_;
+    std::unique_ptr<WriteTracker> write_tracker_;
+    
+    std::string get_connection_string(const std::string& host, const std::string& port);
+    template <typename Read>
+    auto run_read(Read&& read);
+    void mark_session_written();
+    
+    // Column positions of a user SELECT, looked up once per result.
+    struct UserColumns {
+        explicit UserColumns(const pqxx::result& result);
+        pqxx::row::size_type id;
+        pqxx::row::size_type username;
+        pqxx::row::size_type email;
+        pqxx::row::size_type first_name;
+        pqxx::row::size_type last_name;
+        pqxx::row::size_type created_at;
+        pqxx::row::size_type updated_at;
+    };
     
-    std::string get_connection_string();
-    User row_to_user(const pqxx::row& row);
+    User row_to_user(const pqxx::row& row, const UserColumns& columns);
 };
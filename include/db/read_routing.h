@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using RoutingClock = std::chrono::steady_clock;
+
+// Binds the current thread to one request of a client session. Reads after
+// a write in the same request, or within the WriteTracker window of a write
+// by the same non-empty session id, are served by the primary.
+class SessionScope {
+public:
+    explicit SessionScope(std::string session_id);
+    ~SessionScope();
+    SessionScope(const SessionScope&) = delete;
+    SessionScope& operator=(const SessionScope&) = delete;
+
+    static const std::string& current_session();
+    static bool request_wrote();
+    static void mark_request_wrote();
+
+private:
+    std::string previous_;
+    bool previous_wrote_;
+};
+
+// Round-robin over replica indexes, skipping any that failed less than
+// `cooldown` ago.
+class ReplicaSelector {
+public:
+    ReplicaSelector(std::size_t count, std::chrono::milliseconds cooldown);
+
+    std::optional<std::size_t> select(RoutingClock::time_point now);
+    void mark_failed(std::size_t index, RoutingClock::time_point now);
+
+private:
+    std::vector<RoutingClock::time_point> unavailable_until_;
+    std::chrono::milliseconds cooldown_;
+    std::size_t next_ = 0;
+    std::mutex mutex_;
+};
+
+// Remembers which sessions wrote within the last `window`.
+class WriteTracker {
+public:
+    explicit WriteTracker(std::chrono::milliseconds window);
+
+    // Records a write by the session bound with SessionScope.
+    void mark_written(RoutingClock::time_point now);
+
+    // True if reads in the current SessionScope must go to the primary.
+    bool is_sticky(RoutingClock::time_point now);
+
+    std::size_t tracked_sessions();
+
+private:
+    std::chrono::milliseconds window_;
+    std::unordered_map<std::string, RoutingClock::time_point> last_write_;
+    // Writes in the order they happened, so expired sessions are removed
+    // from the front without scanning every tracked session.
+    std::deque<std::pair<RoutingClock::time_point, std::string>> expiry_;
+    std::mutex mutex_;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+using Uuid = std::array<std::uint8_t, 16>;
+
+// Timestamps are microseconds since the Unix epoch; the text forms are
+// produced by uuid_to_string/format_timestamp when a response is built.
+struct User {
+    Uuid id{};
+    std::string username;
+    std::string email;
+    std::string first_name;
+    std::string last_name;
+    std::int64_t created_at = 0;
+    std::int64_t updated_at = 0;
+};
+
+Uuid parse_uuid(std::string_view text);
+std::string uuid_to_string(const Uuid& id);
+std::string format_timestamp(std::int64_t epoch_us);
@@ -1,6 +1,47 @@
 #include "db/database.h"
+#include <charconv>
 #include <cstdlib>
+#include <cstring>
+#include <sstream>
 #include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Timestamps are fetched as integer microseconds so the client never parses
+// the server's text timestamp format.
+constexpr const char* USER_COLUMNS =
+    "SELECT id, username, email, first_name, last_name, "
+    "(EXTRACT(EPOCH FROM created_at) * 1000000)::BIGINT AS created_at, "
+    "(EXTRACT(EPOCH FROM updated_at) * 1000000)::BIGINT AS updated_at "
+    "FROM users";
+
+std::string field_to_string(const pqxx::field& field) {
+    return field.is_null() ? std::string() : std::string(field.c_str(), field.size());
+}
+
+std::string env_or(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return (value && *value) ? value : fallback;
+}
+
+// Accepts only a plain non-negative decimal integer: "-1" or "5abc" are
+// rejected instead of wrapping around or being silently truncated.
+std::size_t env_size(const char* name, std::size_t fallback) {
+    const char* value = std::getenv(name);
+    if (!value || !*value) {
+        return fallback;
+    }
+    const char* end = value + std::strlen(value);
+    long long parsed = 0;
+    auto [ptr, ec] = std::from_chars(value, end, parsed);
+    if (ec != std::errc() || ptr != end || parsed < 0) {
+        throw std::runtime_error(std::string("Invalid value for ") + name + ": " + value);
+    }
+    return static_cast<std::size_t>(parsed);
+}
+
+} // namespace
 
 Database& Database::instance() {
     static Database db;
@@ -8,44 +49,104 @@ Database& Database::instance() {
 }
 
 Database::Database() {
+    const std::size_t pool_size = env_size("DB_POOL_SIZE", 4);
+    const std::string default_port = env_or("DB_PORT", "5432");
+    
+    write_tracker_ = std::make_unique<WriteTracker>(
+        std::chrono::milliseconds(env_size("DB_STICKY_WINDOW_MS", 5000)));
+    
     try {
-        conn_ = std::make_unique<pqxx::connection>(get_connection_string());
-        if (!conn_->is_open()) {
+        primary_ = std::make_unique<ConnectionPool>(
+            get_connection_string(env_or("DB_HOST", "localhost"), default_port), pool_size);
+        auto conn = primary_->acquire();
+        if (!conn->is_open()) {
             throw std::runtime_error("Failed to open database connection");
         }
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Database connection error: ") + e.what());
     }
+    
+    // DB_REPLICA_HOSTS is a comma-separated list of host[:port] entries.
+    // Replica connections are opened lazily so a replica that is down does
+    // not prevent startup; reads fall back to the primary instead and the
+    // replica is skipped until DB_REPLICA_COOLDOWN_MS has passed.
+    std::stringstream replicas(env_or("DB_REPLICA_HOSTS", ""));
+    std::string endpoint;
+    while (std::getline(replicas, endpoint, ',')) {
+        if (endpoint.empty()) {
+            continue;
+        }
+        std::string host = endpoint;
+        std::string port = default_port;
+        auto colon = endpoint.rfind(':');
+        if (colon != std::string::npos) {
+            host = endpoint.substr(0, colon);
+            port = endpoint.substr(colon + 1);
+        }
+        replicas_.push_back(std::make_unique<ConnectionPool>(
+            get_connection_string(host, port), pool_size));
+    }
+    replica_selector_ = std::make_unique<ReplicaSelector>(
+        replicas_.size(), std::chrono::milliseconds(env_size("DB_REPLICA_COOLDOWN_MS", 30000)));
 }
 
-std::string Database::get_connection_string() {
-    const char* host = std::getenv("DB_HOST");
-    const char* port = std::getenv("DB_PORT");
-    const char* dbname = std::getenv("DB_NAME");
-    const char* user = std::getenv("DB_USER");
-    const char* password = std::getenv("DB_PASSWORD");
-    
+std::string Database::get_connection_string(const std::string& host, const std::string& port) {
     std::string conn_str = "postgresql://";
-    conn_str += (user ? user : "postgres");
+    conn_str += env_or("DB_USER", "postgres");
     conn_str += ":";
-    conn_str += (password ? password : "postgres");
+    conn_str += env_or("DB_PASSWORD", "postgres");
     conn_str += "@";
-    conn_str += (host ? host : "localhost");
+    conn_str += host;
     conn_str += ":";
-    conn_str += (port ? port : "5432");
+    conn_str += port;
     conn_str += "/";
-    conn_str += (dbname ? dbname : "pipo_db");
+    conn_str += env_or("DB_NAME", "pipo_db");
+    // libpq connects synchronously on the io_context thread, so an
+    // unreachable host must not block it for the OS TCP timeout.
+    conn_str += "?connect_timeout=";
+    conn_str += env_or("DB_CONNECT_TIMEOUT", "2");
     
     return conn_str;
 }
 
+// Runs `read` on a replica when one is available, and again on the primary
+// if the replica connection turns out to be broken at any point.
+template <typename Read>
+auto Database::run_read(Read&& read) {
+    const auto now = RoutingClock::now();
+    if (!write_tracker_->is_sticky(now)) {
+        if (auto index = replica_selector_->select(now)) {
+            ConnectionPool& replica = *replicas_[*index];
+            try {
+                auto conn = replica.acquire();
+                pqxx::read_transaction txn(*conn);
+                return read(txn);
+            } catch (const pqxx::broken_connection&) {
+                // Idle connections to a failed replica are most likely
+                // broken as well.
+                replica.clear_idle();
+                replica_selector_->mark_failed(*index, RoutingClock::now());
+            }
+        }
+    }
+    
+    auto conn = primary_->acquire();
+    pqxx::read_transaction txn(*conn);
+    return read(txn);
+}
+
+void Database::mark_session_written() {
+    write_tracker_->mark_written(RoutingClock::now());
+}
+
 std::string Database::create_user(const std::string& username,
                                    const std::string& email,
                                    const std::string& password_hash,
                                    const std::string& first_name,
                                    const std::string& last_name) {
     try {
-        pqxx::work txn(*conn_);
+        auto conn = primary_->acquire();
+        pqxx::work txn(*conn);
         
         pqxx::result result = txn.exec_params(
             "INSERT INTO users (username, email, password_hash, first_name, last_name) "
@@ -55,6 +156,7 @@ std::string Database::create_user(const std::string& username,
         );
         
         txn.commit();
+        mark_session_written();
         
         return result[0][0].as<std::string>();
         
@@ -67,19 +169,18 @@ std::string Database::create_user(const std::string& username,
 
 std::optional<User> Database::get_user_by_id(const std::string& user_id) {
     try {
-        pqxx::work txn(*conn_);
-        
-        pqxx::result result = txn.exec_params(
-            "SELECT id, username, email, first_name, last_name, "
-            "created_at, updated_at FROM users WHERE id = $1",
-            user_id
-        );
-        
-        if (result.empty()) {
-            return std::nullopt;
-        }
-        
-        return row_to_user(result[0]);
+        return run_read([&](pqxx::read_transaction& txn) -> std::optional<User> {
+            pqxx::result result = txn.exec_params(
+                std::string(USER_COLUMNS) + " WHERE id = $1",
+                user_id
+            );
+            
+            if (result.empty()) {
+                return std::nullopt;
+            }
+            
+            return row_to_user(result[0], UserColumns(result));
+        });
         
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Database error: ") + e.what());
@@ -88,19 +189,20 @@ std::optional<User> Database::get_user_by_id(const std::string& user_id) {
 
 std::vector<User> Database::get_all_users() {
     try {
-        pqxx::work txn(*conn_);
-        
-        pqxx::result result = txn.exec(
-            "SELECT id, username, email, first_name, last_name, "
-            "created_at, updated_at FROM users ORDER BY created_at DESC"
-        );
-        
-        std::vector<User> users;
-        for (const auto& row : result) {
-            users.push_back(row_to_user(row));
-        }
-        
-        return users;
+        return run_read([&](pqxx::read_transaction& txn) {
+            pqxx::result result = txn.exec(
+                std::string(USER_COLUMNS) + " ORDER BY users.created_at DESC"
+            );
+            
+            const UserColumns columns(result);
+            std::vector<User> users;
+            users.reserve(result.size());
+            for (const auto& row : result) {
+                users.push_back(row_to_user(row, columns));
+            }
+            
+            return users;
+        });
         
     } catch (const std::exception& e) {
         throw std::runtime_error(std::string("Database error: ") + e.what());
@@ -113,7 +215,8 @@ bool Database::update_user(const std::string& user_id,
                           const std::string& first_name,
                           const std::string& last_name) {
     try {
-        pqxx::work txn(*conn_);
+        auto conn = primary_->acquire();
+        pqxx::work txn(*conn);
         
         std::string query = "UPDATE users SET updated_at = CURRENT_TIMESTAMP";
         std::vector<std::string> params;
@@ -153,6 +256,7 @@ bool Database::update_user(const std::string& user_id,
         }
         
         txn.commit();
+        mark_session_written();
         
         return result.affected_rows() > 0;
         
@@ -165,7 +269,8 @@ bool Database::update_user(const std::string& user_id,
 
 bool Database::delete_user(const std::string& user_id) {
     try {
-        pqxx::work txn(*conn_);
+        auto conn = primary_->acquire();
+        pqxx::work txn(*conn);
         
         pqxx::result result = txn.exec_params(
             "DELETE FROM users WHERE id = $1",
@@ -173,6 +278,7 @@ bool Database::delete_user(const std::string& user_id) {
         );
         
         txn.commit();
+        mark_session_written();
         
         return result.affected_rows() > 0;
         
@@ -181,14 +287,25 @@ bool Database::delete_user(const std::string& user_id) {
     }
 }
 
-User Database::row_to_user(const pqxx::row& row) {
+Database::UserColumns::UserColumns(const pqxx::result& result)
+    : id(result.column_number("id")),
+      username(result.column_number("username")),
+      email(result.column_number("email")),
+      first_name(result.column_number("first_name")),
+      last_name(result.column_number("last_name")),
+      created_at(result.column_number("created_at")),
+      updated_at(result.column_number("updated_at")) {
+}
+
+User Database::row_to_user(const pqxx::row& row, const UserColumns& columns) {
     User user;
-    user.id = row["id"].as<std::string>();
-    user.username = row["username"].as<std::string>();
-    user.email = row["email"].as<std::string>();
-    user.first_name = row["first_name"].is_null() ? "" : row["first_name"].as<std::string>();
-    user.last_name = row["last_name"].is_null() ? "" : row["last_name"].as<std::string>();
-    user.created_at = row["created_at"].as<std::string>();
-    user.updated_at = row["updated_at"].as<std::string>();
+    const pqxx::field id = row[columns.id];
+    user.id = parse_uuid(std::string_view(id.c_str(), id.size()));
+    user.username = field_to_string(row[columns.username]);
+    user.email = field_to_string(row[columns.email]);
+    user.first_name = field_to_string(row[columns.first_name]);
+    user.last_name = field_to_string(row[columns.last_name]);
+    user.created_at = row[columns.created_at].as<std::int64_t>();
+    user.updated_at = row[columns.updated_at].as<std::int64_t>();
     return user;
 }
@@ -0,0 +1,107 @@
+#include "db/read_routing.h"
+#include <utility>
+
+namespace {
+
+thread_local std::string thread_session;
+thread_local bool thread_request_wrote = false;
+
+} // namespace
+
+SessionScope::SessionScope(std::string session_id)
+    : previous_(std::exchange(thread_session, std::move(session_id))),
+      previous_wrote_(std::exchange(thread_request_wrote, false)) {
+}
+
+SessionScope::~SessionScope() {
+    thread_session = std::move(previous_);
+    thread_request_wrote = previous_wrote_;
+}
+
+const std::string& SessionScope::current_session() {
+    return thread_session;
+}
+
+bool SessionScope::request_wrote() {
+    return thread_request_wrote;
+}
+
+void SessionScope::mark_request_wrote() {
+    thread_request_wrote = true;
+}
+
+ReplicaSelector::ReplicaSelector(std::size_t count, std::chrono::milliseconds cooldown)
+    : unavailable_until_(count), cooldown_(cooldown) {
+}
+
+std::optional<std::size_t> ReplicaSelector::select(RoutingClock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t count = unavailable_until_.size();
+    if (count == 0) {
+        return std::nullopt;
+    }
+
+    const std::size_t start = next_++ % count;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::size_t index = (start + i) % count;
+        if (unavailable_until_[index] <= now) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+void ReplicaSelector::mark_failed(std::size_t index, RoutingClock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    unavailable_until_.at(index) = now + cooldown_;
+}
+
+WriteTracker::WriteTracker(std::chrono::milliseconds window)
+    : window_(window) {
+}
+
+void WriteTracker::mark_written(RoutingClock::time_point now) {
+    SessionScope::mark_request_wrote();
+    const std::string& session = SessionScope::current_session();
+    if (session.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!expiry_.empty() && now - expiry_.front().first >= window_) {
+        auto it = last_write_.find(expiry_.front().second);
+        // Skip sessions that wrote again after this entry was queued.
+        if (it != last_write_.end() && it->second == expiry_.front().first) {
+            last_write_.erase(it);
+        }
+        expiry_.pop_front();
+    }
+    last_write_[session] = now;
+    expiry_.emplace_back(now, session);
+}
+
+bool WriteTracker::is_sticky(RoutingClock::time_point now) {
+    if (SessionScope::request_wrote()) {
+        return true;
+    }
+    const std::string& session = SessionScope::current_session();
+    if (session.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = last_write_.find(session);
+    if (it == last_write_.end()) {
+        return false;
+    }
+    if (now - it->second >= window_) {
+        last_write_.erase(it);
+        return false;
+    }
+    return true;
+}
+
+std::size_t WriteTracker::tracked_sessions() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_write_.size();
+}
@@ -0,0 +1,86 @@
+#include "db/user.h"
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+Uuid parse_uuid(std::string_view text) {
+    Uuid id{};
+    std::size_t nibble = 0;
+    for (char c : text) {
+        if (c == '-') {
+            continue;
+        }
+        int value = hex_value(c);
+        if (value < 0 || nibble >= 32) {
+            throw std::runtime_error("Invalid UUID: " + std::string(text));
+        }
+        id[nibble / 2] |= static_cast<std::uint8_t>(nibble % 2 == 0 ? value << 4 : value);
+        ++nibble;
+    }
+    if (nibble != 32) {
+        throw std::runtime_error("Invalid UUID: " + std::string(text));
+    }
+    return id;
+}
+
+std::string uuid_to_string(const Uuid& id) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string text;
+    text.reserve(36);
+    for (std::size_t i = 0; i < id.size(); ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            text += '-';
+        }
+        text += digits[id[i] >> 4];
+        text += digits[id[i] & 0x0f];
+    }
+    return text;
+}
+
+// Matches PostgreSQL's text output for TIMESTAMP: fractional seconds are
+// printed only when present, without trailing zeros, and years before 1 AD
+// are written as positive BC years (astronomical year 0 is 1 BC).
+std::string format_timestamp(std::int64_t epoch_us) {
+    using namespace std::chrono;
+    
+    sys_time<microseconds> tp{microseconds(epoch_us)};
+    auto day = floor<days>(tp);
+    year_month_day ymd{day};
+    hh_mm_ss<microseconds> time{tp - day};
+    
+    const int year = static_cast<int>(ymd.year());
+    const bool bc = year <= 0;
+    
+    char buffer[40];
+    int length = std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u %02lld:%02lld:%02lld",
+                               bc ? 1 - year : year,
+                               static_cast<unsigned>(ymd.month()),
+                               static_cast<unsigned>(ymd.day()),
+                               static_cast<long long>(time.hours().count()),
+                               static_cast<long long>(time.minutes().count()),
+                               static_cast<long long>(time.seconds().count()));
+    std::string text(buffer, length);
+    
+    auto fraction = time.subseconds().count();
+    if (fraction != 0) {
+        std::snprintf(buffer, sizeof(buffer), ".%06lld", static_cast<long long>(fraction));
+        std::string digits(buffer);
+        digits.erase(digits.find_last_not_of('0') + 1);
+        text += digits;
+    }
+    if (bc) {
+        text += " BC";
+    }
+    return text;
+}
@@ -1,6 +1,7 @@
 #include "handlers/user_handler.h"
 #include "db/database.h"
 #include <regex>
+#include <utility>
 
 http::response<http::string_body> UserHandler::create_user(
     const http::request<http::string_body>& req) {
@@ -62,13 +63,13 @@ http::response<http::string_body> UserHandler::get_user(const std::string& user_
         
         User user = user_opt.value();
         json response;
-        response["id"] = user.id;
+        response["id"] = uuid_to_string(user.id);
         response["username"] = user.username;
         response["email"] = user.email;
         response["first_name"] = user.first_name;
         response["last_name"] = user.last_name;
-        response["created_at"] = user.created_at;
-        response["updated_at"] = user.updated_at;
+        response["created_at"] = format_timestamp(user.created_at);
+        response["updated_at"] = format_timestamp(user.updated_at);
         
         res.result(http::status::ok);
         res.body() = response.dump();
@@ -93,16 +94,17 @@ http::response<http::string_body> UserHandler::get_all_users() {
         std::vector<User> users = Database::instance().get_all_users();
         
         json response = json::array();
+        response.get_ref<json::array_t&>().reserve(users.size());
         for (const auto& user : users) {
             json user_json;
-            user_json["id"] = user.id;
+            user_json["id"] = uuid_to_string(user.id);
             user_json["username"] = user.username;
             user_json["email"] = user.email;
             user_json["first_name"] = user.first_name;
             user_json["last_name"] = user.last_name;
-            user_json["created_at"] = user.created_at;
-            user_json["updated_at"] = user.updated_at;
-            response.push_back(user_json);
+            user_json["created_at"] = format_timestamp(user.created_at);
+            user_json["updated_at"] = format_timestamp(user.updated_at);
+            response.push_back(std::move(user_json));
         }
         
         res.result(http::status::ok);
@@ -160,12 +162,12 @@ http::response<http::string_body> UserHandler::update_user(
         if (user_opt.has_value()) {
             User user = user_opt.value();
             json response;
-            response["id"] = user.id;
+            response["id"] = uuid_to_string(user.id);
             response["username"] = user.username;
             response["email"] = user.email;
             response["first_name"] = user.first_name;
             response["last_name"] = user.last_name;
-            response["updated_at"] = user.updated_at;
+            response["updated_at"] = format_timestamp(user.updated_at);
             
             res.result(http::status::ok);
             res.body() = response.dump();
@@ -1,5 +1,6 @@
 #include "server.h"
 #include "handlers/user_handler.h"
+#include "db/database.h"
 #include <boost/beast/core.hpp>
 #include <boost/beast/http.hpp>
 #include <iostream>
@@ -30,6 +31,7 @@ private:
     }
 
     void handle_request() {
+        SessionScope db_session(session_id());
         http::response<http::string_body> res;
         
         std::string target = std::string(req_.target());
@@ -57,6 +59,17 @@ private:
         do_write(std::move(res));
     }
 
+    // Read-your-writes across requests needs the client to send a stable
+    // X-Session-Id. The remote address is not used: behind a proxy or NAT
+    // it is shared by many clients and would pin them all to the primary.
+    std::string session_id() const {
+        auto header = req_.find("X-Session-Id");
+        if (header == req_.end()) {
+            return std::string();
+        }
+        return std::string(header->value());
+    }
+
     void do_write(http::response<http::string_body> res) {
         auto self = shared_from_this();
         auto sp = std::make_shared<http::response<http::string_body>>(std::move(res));
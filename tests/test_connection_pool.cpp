@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "db/connection_pool.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct FakeConnection {
+    explicit FakeConnection(const std::string& conn_str) {
+        if (conn_str == "unreachable") {
+            throw std::runtime_error("connection refused");
+        }
+    }
+    bool is_open() const { return open; }
+    bool open = true;
+};
+
+using FakePool = BasicConnectionPool<FakeConnection>;
+
+} // namespace
+
+TEST(ConnectionPoolTest, ReusesReleasedConnection) {
+    FakePool pool("db", 2);
+    FakeConnection* first = nullptr;
+    {
+        auto lease = pool.acquire();
+        first = &*lease;
+        EXPECT_EQ(pool.open_connections(), 1u);
+    }
+    auto lease = pool.acquire();
+    EXPECT_EQ(&*lease, first);
+    EXPECT_EQ(pool.open_connections(), 1u);
+}
+
+TEST(ConnectionPoolTest, DropsBrokenConnectionOnRelease) {
+    FakePool pool("db", 2);
+    {
+        auto lease = pool.acquire();
+        lease->open = false;
+    }
+    EXPECT_EQ(pool.open_connections(), 0u);
+}
+
+TEST(ConnectionPoolTest, ClearIdleKeepsLeasedConnections) {
+    FakePool pool("db", 3);
+    auto leased = pool.acquire();
+    {
+        auto a = pool.acquire();
+        auto b = pool.acquire();
+    }
+    EXPECT_EQ(pool.open_connections(), 3u);
+
+    pool.clear_idle();
+    EXPECT_EQ(pool.open_connections(), 1u);
+}
+
+TEST(ConnectionPoolTest, FailedConnectDoesNotLeakSlot) {
+    FakePool pool("unreachable", 1);
+    EXPECT_THROW(pool.acquire(), std::runtime_error);
+    EXPECT_EQ(pool.open_connections(), 0u);
+    // With size 1 a leaked slot would block here instead of throwing.
+    EXPECT_THROW(pool.acquire(), std::runtime_error);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "db/read_routing.h"
+#include <optional>
+#include <string>
+
+using namespace std::chrono_literals;
+
+TEST(ReplicaSelectorTest, NoReplicas) {
+    ReplicaSelector selector(0, 1000ms);
+    EXPECT_EQ(selector.select(RoutingClock::now()), std::nullopt);
+}
+
+TEST(ReplicaSelectorTest, RoundRobin) {
+    ReplicaSelector selector(3, 1000ms);
+    const auto now = RoutingClock::now();
+    EXPECT_EQ(selector.select(now), 0u);
+    EXPECT_EQ(selector.select(now), 1u);
+    EXPECT_EQ(selector.select(now), 2u);
+    EXPECT_EQ(selector.select(now), 0u);
+}
+
+TEST(ReplicaSelectorTest, SkipsFailedReplicaDuringCooldown) {
+    ReplicaSelector selector(3, 1000ms);
+    const auto now = RoutingClock::now();
+    selector.mark_failed(1, now);
+
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_NE(selector.select(now + 999ms), 1u);
+    }
+}
+
+TEST(ReplicaSelectorTest, FailedReplicaReturnsAfterCooldown) {
+    ReplicaSelector selector(2, 1000ms);
+    const auto now = RoutingClock::now();
+    selector.mark_failed(0, now);
+
+    EXPECT_EQ(selector.select(now), 1u);
+    EXPECT_EQ(selector.select(now), 1u);
+    EXPECT_EQ(selector.select(now + 1000ms), 0u);
+    EXPECT_EQ(selector.select(now + 1000ms), 1u);
+}
+
+TEST(ReplicaSelectorTest, AllReplicasFailed) {
+    ReplicaSelector selector(2, 1000ms);
+    const auto now = RoutingClock::now();
+    selector.mark_failed(0, now);
+    selector.mark_failed(1, now);
+    EXPECT_EQ(selector.select(now + 500ms), std::nullopt);
+}
+
+TEST(WriteTrackerTest, NoWriteIsNotSticky) {
+    WriteTracker tracker(1000ms);
+    SessionScope scope("client");
+    EXPECT_FALSE(tracker.is_sticky(RoutingClock::now()));
+}
+
+TEST(WriteTrackerTest, WriteIsStickyWithinRequestWithoutSessionId) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    {
+        SessionScope scope("");
+        tracker.mark_written(now);
+        EXPECT_TRUE(tracker.is_sticky(now + 5000ms));
+    }
+    SessionScope next_request("");
+    EXPECT_FALSE(tracker.is_sticky(now));
+    EXPECT_EQ(tracker.tracked_sessions(), 0u);
+}
+
+TEST(WriteTrackerTest, SessionIsStickyUntilWindowExpires) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    {
+        SessionScope scope("client");
+        tracker.mark_written(now);
+    }
+    SessionScope scope("client");
+    EXPECT_TRUE(tracker.is_sticky(now + 999ms));
+    EXPECT_FALSE(tracker.is_sticky(now + 1000ms));
+}
+
+TEST(WriteTrackerTest, OtherSessionsAreNotSticky) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    {
+        SessionScope scope("writer");
+        tracker.mark_written(now);
+    }
+    SessionScope scope("reader");
+    EXPECT_FALSE(tracker.is_sticky(now));
+}
+
+TEST(WriteTrackerTest, NestedScopeRestoresOuterRequest) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    SessionScope outer("outer");
+    tracker.mark_written(now);
+    {
+        SessionScope inner("inner");
+        EXPECT_EQ(SessionScope::current_session(), "inner");
+        EXPECT_FALSE(SessionScope::request_wrote());
+    }
+    EXPECT_EQ(SessionScope::current_session(), "outer");
+    EXPECT_TRUE(SessionScope::request_wrote());
+}
+
+TEST(WriteTrackerTest, ExpiredSessionsAreDroppedOnWrite) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    for (int i = 0; i < 100; ++i) {
+        SessionScope scope("client-" + std::to_string(i));
+        tracker.mark_written(now);
+    }
+    EXPECT_EQ(tracker.tracked_sessions(), 100u);
+
+    SessionScope scope("late");
+    tracker.mark_written(now + 1000ms);
+    EXPECT_EQ(tracker.tracked_sessions(), 1u);
+}
+
+TEST(WriteTrackerTest, RepeatedWriteExtendsWindow) {
+    WriteTracker tracker(1000ms);
+    const auto now = RoutingClock::now();
+    {
+        SessionScope scope("client");
+        tracker.mark_written(now);
+        tracker.mark_written(now + 800ms);
+    }
+    {
+        SessionScope scope("other");
+        tracker.mark_written(now + 1200ms);
+    }
+    SessionScope scope("client");
+    EXPECT_TRUE(tracker.is_sticky(now + 1500ms));
+    EXPECT_FALSE(tracker.is_sticky(now + 1800ms));
+}
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include "db/user.h"
+#include <stdexcept>
+
+// Expected strings are PostgreSQL's text output for the same TIMESTAMP.
+
+TEST(FormatTimestampTest, Epoch) {
+    EXPECT_EQ(format_timestamp(0), "1970-01-01 00:00:00");
+}
+
+TEST(FormatTimestampTest, WholeSecondsHaveNoFraction) {
+    EXPECT_EQ(format_timestamp(1700000000000000), "2023-11-14 22:13:20");
+}
+
+TEST(FormatTimestampTest, TrailingZerosAreTrimmed) {
+    EXPECT_EQ(format_timestamp(1709193903123450), "2024-02-29 08:05:03.12345");
+    EXPECT_EQ(format_timestamp(1700000000100000), "2023-11-14 22:13:20.1");
+    EXPECT_EQ(format_timestamp(1700000000000001), "2023-11-14 22:13:20.000001");
+}
+
+TEST(FormatTimestampTest, BeforeEpoch) {
+    EXPECT_EQ(format_timestamp(-1), "1969-12-31 23:59:59.999999");
+    EXPECT_EQ(format_timestamp(-2203934399880000), "1900-02-28 12:00:00.12");
+}
+
+TEST(FormatTimestampTest, FirstYearAD) {
+    EXPECT_EQ(format_timestamp(-62135596800000000), "0001-01-01 00:00:00");
+}
+
+TEST(FormatTimestampTest, YearsBeforeChristAreSuffixedBC) {
+    EXPECT_EQ(format_timestamp(-62135596800500000), "0001-12-31 23:59:59.5 BC");
+    EXPECT_EQ(format_timestamp(-63517824000000000), "0044-03-15 00:00:00 BC");
+}
+
+TEST(UuidTest, RoundTrip) {
+    const std::string text = "0f8fad5b-d9cb-469f-a165-70867728950e";
+    Uuid id = parse_uuid(text);
+    EXPECT_EQ(id[0], 0x0f);
+    EXPECT_EQ(id[15], 0x0e);
+    EXPECT_EQ(uuid_to_string(id), text);
+}
+
+TEST(UuidTest, UppercaseInputIsNormalizedToLowercase) {
+    EXPECT_EQ(uuid_to_string(parse_uuid("0F8FAD5B-D9CB-469F-A165-70867728950E")),
+              "0f8fad5b-d9cb-469f-a165-70867728950e");
+}
+
+TEST(UuidTest, RejectsMalformedInput) {
+    EXPECT_THROW(parse_uuid(""), std::runtime_error);
+    EXPECT_THROW(parse_uuid("0f8fad5b-d9cb-469f-a165-70867728950"), std::runtime_error);
+    EXPECT_THROW(parse_uuid("0f8fad5b-d9cb-469f-a165-70867728950e0"), std::runtime_error);
+    EXPECT_THROW(parse_uuid("0f8fad5b-d9cb-469f-a165-70867728950g"), std::runtime_error);
+}